@@ -0,0 +1,61 @@
+#
+# Synthetic .bench netlist for the benchmarks:
+#
+#   awk -v gates=N [-v depth=D] [-v seed=S] -f synth.awk > synthN.bench
+#
+# N gates in D levels (40 by default) of N/D gates each.  A gate is
+# driven by 2 or 3 gates of a near position in the last 3 levels (an
+# inverter by one), so fanin cones stay local as in a datapath.  The
+# first level reads the inputs, the last one drives the 32 outputs.
+# It uses the cells of gaussdelay.dlib, and a Park-Miller generator
+# keeps the netlist the same for every awk.
+#
+
+function random(n) {
+    x = (x * 16807) % 2147483647
+    return x % n
+}
+
+# a signal of level l-1-random(3) near position p
+function driver(l, p,   k, q) {
+    k = l - 1 - random(3)
+    if( k < 0 ) k = -1
+    q = ( p + random(9) - 4 + width ) % width
+    if( k < 0 )
+        return "I" (q % num_inputs)
+    return "G" (k*width + q)
+}
+
+BEGIN {
+    if( gates <= 0 ) gates = 10000
+    if( depth <= 0 ) depth = 40
+    x = ( seed ? seed : 1 )
+    width = int(gates/depth)
+    if( width < 1 ) width = 1
+    num_inputs = ( width < 64 ? width : 64 + int(width/16) )
+    num_outputs = ( width < 32 ? width : 32 )
+    split("NAND NOR AND OR", type, " ")
+
+    for( i = 0; i < num_inputs; i++ )
+        print "INPUT(I" i ")"
+    print ""
+    for( i = 0; i < num_outputs; i++ )
+        print "OUTPUT(G" ((depth-1)*width + int(i*width/num_outputs)) ")"
+    print ""
+
+    for( l = 0; l < depth; l++ ) {
+        for( p = 0; p < width; p++ ) {
+            g = l*width + p
+            if( random(10) == 0 ) {
+                line = "G" g " = NOT(" driver(l, p) ")"
+            } else {
+                k = 2 + random(2)
+                line = "G" g " = " type[1+random(4)] "("
+                for( i = 0; i < k; i++ )
+                    line = line ( i ? ", " : "" ) driver(l, p)
+                line = line ")"
+            }
+            print line
+        }
+    }
+}
@@ -11,8 +11,12 @@ namespace RandomVariable {
 	class OpADD : public _RandomVariable_ {
 	public:
 
-		OpADD( const RandomVariable& left, const RandomVariable& righ );
-		virtual ~OpADD();
+		OpADD
+		(
+			Context& context,
+			const RandomVariable& left,
+			const RandomVariable& right
+			);
 
 	private:
 
@@ -0,0 +1,55 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_ARENA__H
+#define NH_ARENA__H
+
+#include <cstddef>
+#include <vector>
+
+namespace RandomVariable {
+
+    // Bump allocator behind the nodes of one analysis.  Memory is taken
+    // from large blocks and only given back, all at once, when the
+    // arena goes away; nothing allocated here is ever destroyed one by
+    // one, so only trivially destructible state may live in it.
+    class Arena {
+    public:
+
+		explicit Arena(size_t block_bytes = size_t(1) << 20);
+		~Arena();
+
+		void* allocate(size_t bytes, size_t align) {
+			char* p = reinterpret_cast<char*>
+				( ( reinterpret_cast<size_t>(next_) + align-1 ) & ~(align-1) );
+			if( end_ < p + bytes ) {
+				p = new_block(bytes, align);
+			}
+			next_ = p + bytes;
+			used_ += bytes;
+			return p;
+		}
+
+		size_t used() const { return used_; }
+		size_t bytes() const { return bytes_; }
+
+		// gives back all blocks, as if the arena were new
+		void clear();
+
+    private:
+
+		Arena(const Arena&);
+		Arena& operator = (const Arena&);
+
+		char* new_block(size_t bytes, size_t align);
+
+		std::vector<char*> blocks_;
+		char* next_;
+		char* end_;
+		size_t block_bytes_;
+		size_t used_;
+		size_t bytes_;
+    };
+}
+
+#endif // NH_ARENA__H
@@ -0,0 +1,162 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_CANONICAL__H
+#define NH_CANONICAL__H
+
+#include <cstddef>
+
+namespace RandomVariable {
+
+    // First order canonical form of a delay,
+    //   mean + sum of a_i X_i + R
+    // over independent standard normal sources X_i, where R is a normal
+    // of variance residual() private to this form.  Sums and maxes work
+    // on the coefficients, so the covariance of two forms is the dot
+    // product of their coefficients and never walks an expression.
+    //
+    // A form depends on the sources of its fanin cone only, so the
+    // coefficients are kept sparse, sorted by source.  Forms of one or
+    // two sources, as the delay of an arc, need no allocation.
+    //
+    // T is the scalar of the mean and the coefficients: Canonical for
+    // double, CanonicalFloat for --precision float, of half the terms
+    // size; both are instantiated in Canonical.C.
+    template<class T>
+    class BasicCanonical {
+    public:
+
+		typedef T Scalar;
+
+		struct Term {
+			int source;
+			T coef;
+		};
+
+		BasicCanonical() : mean_(0), residual_(0) {}
+
+		// the constant mean
+		explicit BasicCanonical(double mean) : mean_(mean), residual_(0) {}
+
+		// mean + sqrt(variance) X_source
+		BasicCanonical(double mean, int source, double variance);
+
+		// the same form in other precision
+		template<class U>
+		explicit BasicCanonical(const BasicCanonical<U>& a);
+
+		double mean() const { return mean_; }
+		double variance() const;
+		double residual() const { return residual_; }
+
+		int num_terms() const { return terms_.size(); }
+		const Term& term(int i) const { return terms_[i]; }
+
+		BasicCanonical& operator += (const BasicCanonical& b);
+
+		// makes the residual the coefficient of a new source, so that
+		// forms derived from this one share it instead of each taking
+		// it as independent
+		void set_residual_source(int source);
+
+		// moves the coefficients with a_i^2 < threshold*variance() to
+		// the residual, which keeps the variance
+		void prune(double threshold);
+
+		size_t bytes() const { return terms_.bytes(); }
+
+    private:
+
+		template<class U> friend class BasicCanonical;
+		template<class U> friend BasicCanonical<U> operator +
+		(const BasicCanonical<U>& a, const BasicCanonical<U>& b);
+		template<class U> friend BasicCanonical<U> operator -
+		(const BasicCanonical<U>& a);
+		template<class U> friend BasicCanonical<U> MAX
+		(const BasicCanonical<U>& a, const BasicCanonical<U>& b,
+		 double& tightness);
+
+		// sorted terms, the first INLINE of them in place
+		class Terms {
+		public:
+			Terms() : data_(inline_), size_(0), capacity_(INLINE) {}
+			Terms(const Terms& t);
+			Terms(Terms&& t) noexcept;
+			~Terms() { if( data_ != inline_ ) delete [] data_; }
+			Terms& operator = (const Terms& t);
+			Terms& operator = (Terms&& t) noexcept;
+
+			int size() const { return size_; }
+			const Term& operator [] (int i) const { return data_[i]; }
+			Term& operator [] (int i) { return data_[i]; }
+
+			void clear() { size_ = 0; }
+			void reserve(int n);
+			void resize(int n) { reserve(n); size_ = n; }
+			void push_back(int source, T coef) {
+				if( size_ == capacity_ ) reserve(2*capacity_);
+				data_[size_].source = source;
+				data_[size_].coef = coef;
+				size_++;
+			}
+
+			size_t bytes() const {
+				return ( data_ == inline_ ? 0 : capacity_*sizeof(Term) );
+			}
+
+		private:
+			enum { INLINE = 2 };
+			Term* data_;
+			int size_;
+			int capacity_;
+			Term inline_[INLINE];
+		};
+
+		T mean_;
+		Terms terms_;
+		T residual_;
+    };
+
+    typedef BasicCanonical<double> Canonical;
+    typedef BasicCanonical<float> CanonicalFloat;
+
+    template<class T>
+    template<class U>
+    BasicCanonical<T>::BasicCanonical(const BasicCanonical<U>& a) :
+		mean_(a.mean_), residual_(a.residual_) {
+		terms_.resize(a.terms_.size());
+		for( int i = 0; i < a.terms_.size(); i++ ) {
+			terms_[i].source = a.terms_[i].source;
+			terms_[i].coef = a.terms_[i].coef;
+		}
+    }
+
+    // merges the coefficients, the residuals add
+    template<class T>
+    BasicCanonical<T> operator + (const BasicCanonical<T>& a,
+								  const BasicCanonical<T>& b);
+
+    // Clark's max of two, with the coefficients T a_i + (1-T) b_i for
+    // the tightness probability T = P(a > b) and the variance the
+    // coefficients miss left in the residual
+    template<class T>
+    BasicCanonical<T> MAX(const BasicCanonical<T>& a,
+						  const BasicCanonical<T>& b);
+    template<class T>
+    BasicCanonical<T> MAX(const BasicCanonical<T>& a,
+						  const BasicCanonical<T>& b, double& tightness);
+
+    // the coefficients and the mean negated, the same residual
+    template<class T>
+    BasicCanonical<T> operator - (const BasicCanonical<T>& a);
+
+    // -MAX(-a,-b), for required times
+    template<class T>
+    BasicCanonical<T> MIN(const BasicCanonical<T>& a,
+						  const BasicCanonical<T>& b);
+
+    template<class T>
+    double covariance(const BasicCanonical<T>& a, const BasicCanonical<T>& b);
+}
+
+#endif // NH_CANONICAL__H
@@ -0,0 +1,141 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_CONTEXT__H
+#define NH_CONTEXT__H
+
+#include <new>
+#include <utility>
+#include <atomic>
+#include <unordered_map>
+#include "Covariance.h"
+#include "Arena.h"
+
+namespace RandomVariable {
+
+    // State of one analysis: the covariance cache, the id space of its
+    // nodes and the arena they live in.  Every node belongs to exactly
+    // one context, so independent analyses can run side by side in one
+    // process, and all of them are released with it at once.
+    class Context {
+    public:
+
+		Context() : next_id_(1), is_hashing_(false), num_shared_(0),
+					is_counting_(false), num_calls_(0),
+					num_walks_(0), num_pairs_(0), max_depth_(0) {
+			for( int k = 0; k < NUM_KINDS; k++ ) num_created_[k] = 0;
+		}
+
+		CovarianceMatrix& covariance_matrix() { return covariance_matrix_; }
+		const CovarianceMatrix& covariance_matrix() const {
+			return covariance_matrix_;
+		}
+
+		// a node of type T, constructed as T(*this, args...)
+		template < class T, class... Args >
+		T* create(Args&&... args) {
+			void* p = arena_.allocate(sizeof(T), alignof(T));
+			T* node = new (p) T( *this, std::forward<Args>(args)... );
+			num_created_[node->kind()]++;
+			return node;
+		}
+
+		// Structural hashing, --strash: with set_hashing(true) a node of
+		// the given kind and key, which stands for its operands, is made
+		// once and returned again for the same kind and key.  Otherwise
+		// the same as create().
+		void set_hashing(bool is_hashing) { is_hashing_ = is_hashing; }
+		bool is_hashing() const { return is_hashing_; }
+
+		template < class T, class... Args >
+		T* share(Kind kind, unsigned long long key, Args&&... args) {
+			if( !is_hashing_ )
+				return create<T>(std::forward<Args>(args)...);
+			_RandomVariable_*& node = shared_[kind][key];
+			if( node ) {
+				num_shared_++;
+			} else {
+				node = create<T>(std::forward<Args>(args)...);
+			}
+			return static_cast<T*>(node);
+		}
+
+		// of the operands a and b, in that order
+		static unsigned long long key(unsigned int a, unsigned int b) {
+			return ( (unsigned long long)a << 32 ) | b;
+		}
+
+		// nodes share() returned again instead of making them
+		unsigned long num_shared() const { return num_shared_; }
+
+		// uninitialized room for n objects of type T, released with
+		// the context
+		template < class T >
+		T* allocate(size_t n) {
+			return static_cast<T*>( arena_.allocate(n*sizeof(T), alignof(T)) );
+		}
+
+		// Drops every node and the covariance cache, keeping its cap,
+		// for a DAG built anew.  No node and no cached pair is left to
+		// tell ids apart, so they start again from 1 and never wrap
+		// over any number of rebuilds; the counts go on.
+		void clear() {
+			next_id_ = 1;
+			size_t max_bytes = covariance_matrix_->max_bytes();
+			covariance_matrix_ = CovarianceMatrix();
+			covariance_matrix_->set_max_bytes(max_bytes);
+			for( int k = 0; k < NUM_KINDS; k++ ) shared_[k].clear();
+			arena_.clear();
+		}
+
+		unsigned int new_id() { return next_id_++; }
+		unsigned int num_nodes() const { return next_id_-1; }
+		const Arena& arena() const { return arena_; }
+		unsigned long num_created(Kind kind) const { return num_created_[kind]; }
+
+		// Counts of covariance(), for --stats: the calls, the walks of
+		// those not found in the cache, the pairs the walks evaluate and
+		// the deepest stack of pending pairs on a thread.  Off by
+		// default, it then costs covariance() one test.
+		void set_counting(bool is_counting) { is_counting_ = is_counting; }
+		bool is_counting() const { return is_counting_; }
+		void count_call() {
+			num_calls_.fetch_add(1, std::memory_order_relaxed);
+		}
+		void count_walk(unsigned long pairs, size_t depth);
+
+		unsigned long num_calls() const { return num_calls_; }
+		unsigned long num_walks() const { return num_walks_; }
+		unsigned long num_pairs() const { return num_pairs_; }
+		size_t max_depth() const { return max_depth_; }
+
+    private:
+
+		Context(const Context&);
+		Context& operator = (const Context&);
+
+		Arena arena_;
+		CovarianceMatrix covariance_matrix_;
+		unsigned int next_id_; // 0 is never a node
+		unsigned long num_created_[NUM_KINDS];
+		bool is_hashing_;
+		std::unordered_map<unsigned long long,_RandomVariable_*> shared_[NUM_KINDS];
+		unsigned long num_shared_;
+		bool is_counting_;
+		std::atomic<unsigned long> num_calls_;
+		std::atomic<unsigned long> num_walks_;
+		std::atomic<unsigned long> num_pairs_;
+		std::atomic<size_t> max_depth_;
+    };
+
+    inline void Context::count_walk(unsigned long pairs, size_t depth) {
+		num_walks_.fetch_add(1, std::memory_order_relaxed);
+		num_pairs_.fetch_add(pairs, std::memory_order_relaxed);
+		size_t max = max_depth_.load(std::memory_order_relaxed);
+		while( max < depth &&
+			   !max_depth_.compare_exchange_weak(max, depth,
+												 std::memory_order_relaxed) ) {}
+    }
+}
+
+#endif // NH_CONTEXT__H
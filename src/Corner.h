@@ -0,0 +1,289 @@
+// -*- c++ -*-
+// Authors: IWAI Jiro
+
+#ifndef NH_CORNER__H
+#define NH_CORNER__H
+
+#include <map>
+#include <vector>
+#include <string>
+#include <ostream>
+#include "SmartPtr.h"
+#include "Gate.h"
+#include "Context.h"
+#include "Canonical.h"
+#include "Netlist.h"
+#include "Parser.h"
+#include "Writer.h"
+
+namespace Nh {
+
+    // One delay library bound to a netlist: its gates, the delay of
+    // every arc and the arrival times it gives.  Corners only read the
+    // netlist, so several of them can be analysed side by side on one
+    // parsed and levelized topology.
+    class Corner {
+    public:
+
+		typedef std::vector<Netlist::Node> Nodes;
+
+		struct Options {
+			Options() : is_nary_max(false), is_canonical(false), is_float(false),
+						prune(0.0), cache_bytes(0), is_counting(false),
+						is_strash(false) {}
+			bool is_nary_max;
+			bool is_canonical;
+			bool is_float;	  // canonical forms in float, --precision float
+			double prune;
+			size_t cache_bytes; // 0 for the default
+			bool is_counting; // covariance() counts for --stats
+			bool is_strash;	  // structural hashing of the DAG
+		};
+
+		Corner(const Netlist& netlist, const std::string& dlib,
+			   const Options& options);
+
+		const std::string& dlib() const { return dlib_; }
+		const Options& options() const { return options_; }
+
+		void read_dlib();
+
+		// a line of a .dlib, the delay of the arc in -> out of a gate
+		struct DelayLine {
+			std::string gate;
+			std::string in;
+			std::string out;
+			Delay delay;
+		};
+		static void read_dlib_line(Parser& parser, DelayLine& line);
+		void set_delay(const DelayLine& line);
+
+		bool has_gate(const std::string& type) const {
+			return gates_.find(type) != gates_.end();
+		}
+		// throws Gate::exception unless gate type has a delay from
+		// every pin of gate v, before v is retyped
+		void check_type(Netlist::Node v, const std::string& type) const;
+
+		// restricts the arrival times to the marked nodes, which hold
+		// the fanin of each of them; all nodes by default
+		void set_active(const std::vector<char>& is_active) {
+			is_active_ = is_active;
+		}
+		bool is_active(Netlist::Node v) const {
+			return is_active_.empty() || is_active_[v];
+		}
+
+		// delays of the arcs of the netlist, the arrival times and
+		// their moments on jobs threads
+		void bind_delays();
+		void connect_instances();
+		void propagate(unsigned int jobs);
+
+		// arrival times of the nodes, in level order, after an edit of
+		// the netlist or of the delays.  The nodes they replace stay in
+		// the arena; once it is twice the size of the last full build,
+		// the expression DAG is built anew, so a long run of edits holds
+		// at most twice the memory of the netlist.
+		void update(const Nodes& nodes);
+
+		// The next clock cycle, --cycles: every dff launches at
+		// max(0, D - period) + (ck -> q) from its data arrival D of this
+		// cycle, as a transparent latch would, instead of at the edge.
+		// The arrival times are propagated anew level by level, on the
+		// same delay variables, so the cycles are correlated through
+		// them.  The levelized netlist and the delays are reused, but
+		// the expression DAG gets new nodes for every gate each cycle,
+		// as the launch nodes refer to the arrivals of the cycle
+		// before; its arena and covariance cache grow with the cycles.
+		// The canonical forms are overwritten in place instead.
+		void next_cycle(double period, unsigned int jobs);
+		int cycle() const { return cycle_; } // from 0
+
+		// arrival, slack and yield at the data pin of every dff against
+		// the clock period, and their max over all dffs
+		void report_setup(std::ostream& out, double period,
+						  Writer::Format format);
+
+		// current delay of every arc
+		typedef std::vector<Delay> Delays;
+		const Delays& delays() const { return delays_; }
+
+		double mean(Netlist::Node v) const;
+		double variance(Netlist::Node v) const;
+		// in double, converted with is_float
+		::RandomVariable::Canonical canonical(Netlist::Node v) const {
+			if( options_.is_float )
+				return ::RandomVariable::Canonical(float_canonicals_[v]);
+			return canonicals_[v];
+		}
+		// of the expression DAG, and the delay of fanin edge e in it
+		const RandomVariable& signal(Netlist::Node v) const {
+			return signals_[v];
+		}
+		const Normal& edge_delay_variable(int e) const {
+			return edge_delays_[e];
+		}
+		// canonical sources in use, see canonical_output()
+		int num_sources() const { return residual_source(netlist_.num_nodes()); }
+
+		// The probability that each fanin edge of gate v is the max at
+		// its output, weights[e - fanin_begin(v)].  It is the product
+		// of the tightness probabilities of the max of two that fold the
+		// edges, or the weights of the n-ary max; they add up to 1.
+		void fanin_weights(Netlist::Node v, std::vector<double>& weights) const;
+
+		void report_lat(std::ostream& out, const Nodes& nodes,
+						Writer::Format format) const;
+		void report_correlation(std::ostream& out, const Nodes& nodes,
+								Writer::Format format, unsigned int jobs);
+		// the matrix of report_correlation() without printing it
+		void correlate(const Nodes& nodes, unsigned int jobs);
+		// the entries of the matrix with |c| >= threshold, the top of
+		// them by node if top is not 0, see select_correlation()
+		void report_sparse_correlation
+		(
+			std::ostream& out,
+			const Nodes& nodes,
+			Writer::Format format,
+			double threshold,
+			unsigned int top,
+			unsigned int jobs
+			);
+		// --stats as lines of text or as a JSON object
+		void report_stats(std::ostream& out) const;
+		void report_stats_json(std::ostream& out) const;
+
+		// wall clock seconds of the phases, for report_stats()
+		struct Times {
+			Times() : connect(0.0), propagate(0.0), correlation(0.0),
+					  report(0.0), monte_carlo(0.0), slack(0.0) {}
+			double connect;
+			double propagate;
+			double correlation; // the matrix, without printing it
+			double report;		// printing -l and -c
+			double monte_carlo; // added by the caller of MonteCarlo
+			double slack;		// and of Slack
+		};
+		const Times& times() const { return times_; }
+		Times& times() { return times_; }
+
+		// nodes and n x n matrix of the last report_correlation()
+		const Nodes& correlation_nodes() const { return correlation_nodes_; }
+		const std::vector<double>& correlation() const { return correlation_; }
+
+		// the report formats, shared with Snapshot
+		static void print_lat
+		(
+			std::ostream& out,
+			Writer::Format format,
+			const std::vector<std::string>& names,
+			const std::vector<double>& means,
+			const std::vector<double>& variances
+			);
+		static void print_correlation
+		(
+			std::ostream& out,
+			Writer::Format format,
+			const std::vector<std::string>& names,
+			const std::vector<double>& cor
+			);
+
+		// an entry of the correlation of nodes i and j
+		struct Correlation {
+			int i;
+			int j;
+			double c;
+		};
+		typedef std::vector<Correlation> Correlations;
+		// Keeps the entries of i < j with c != 0 and |c| >= threshold.
+		// With top, node i keeps the top of them by |c| as the entries
+		// i, j in both directions, ordered by i and then by |c|.
+		static void select_correlation
+		(
+			Correlations& cors,
+			double threshold,
+			unsigned int top
+			);
+		static void print_sparse_correlation
+		(
+			std::ostream& out,
+			Writer::Format format,
+			const std::vector<std::string>& names,
+			const Correlations& cors
+			);
+
+    private:
+
+		Corner(const Corner&);
+		Corner& operator = (const Corner&);
+
+		// canonical forms of scalar T, double or float with is_float
+		template<class T>
+		std::vector< ::RandomVariable::BasicCanonical<T> >& canonicals();
+		template<class T>
+		std::vector< ::RandomVariable::BasicCanonical<T> >& late_canonicals();
+		template<class T> void propagate_canonical(unsigned int jobs);
+		template<class T> void next_cycle_canonical(double period);
+
+		Normal source();
+		Normal delay(int arc);
+		Normal edge_delay(int e);
+		int residual_source(Netlist::Node v) const {
+			int n = netlist_.num_nodes();
+			return n + netlist_.num_edges() + cycle_*n + v;
+		}
+		RandomVariable instance_output(Netlist::Node v);
+		RandomVariable gate_output(Netlist::Node v);
+		template<class T>
+		::RandomVariable::BasicCanonical<T> canonical_output(Netlist::Node v);
+
+		void correlation_matrix
+		(
+			const Nodes& nodes,
+			std::vector<double>& cor,
+			unsigned int jobs
+			);
+		static void print_line(Writer& out, int num_nodes);
+		double correlation(Netlist::Node a, Netlist::Node b);
+
+		// the structural zeros of the correlation, see correlated_pairs()
+		typedef std::vector< std::vector<int> > Pairs;
+		bool correlated_pairs(const Nodes& nodes, Pairs& pairs,
+							  unsigned int jobs) const;
+		void support(Netlist::Node v, int stamp, std::vector<int>& stamps,
+					 std::vector<int>& roots) const;
+
+		////
+
+		typedef std::map<std::string,Gate> Gates;
+
+		const Netlist& netlist_;
+		std::string dlib_;
+		Options options_;
+		Gates gates_;
+		Context context_;
+		Delays delays_; // by Netlist arc
+		Signals signals_;
+		Normal source_; // of all inputs and dffs with is_strash
+		std::vector<Normal> edge_delays_; // by fanin edge
+		// by fanin edge, the max of the edges of its gate up to it
+		Signals maxes_;
+		// by fanin edge, P(it is later than the max of the edges before
+		// it) with --canonical
+		std::vector<double> joins_;
+		std::vector< ::RandomVariable::Canonical > canonicals_; // --canonical
+		std::vector< ::RandomVariable::CanonicalFloat > float_canonicals_;
+		int cycle_;
+		Signals late_; // by dff, the launch after the edge in cycle_
+		size_t built_bytes_; // of the arena after connect_instances()
+		std::vector< ::RandomVariable::Canonical > late_canonicals_;
+		std::vector< ::RandomVariable::CanonicalFloat > float_late_canonicals_;
+		std::vector<char> is_active_;
+		Nodes correlation_nodes_;
+		mutable Times times_;
+		std::vector<double> correlation_;
+    };
+}
+
+#endif	// NH_CORNER__H
@@ -4,34 +4,109 @@
 #ifndef NH_COVARIANCE__H
 #define NH_COVARIANCE__H
 
-#include <map>
+#include <vector>
+#include <ostream>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include "SmartPtr.h"
 #include "RandomVariable.h"
 #include "Normal.h"
 
 namespace RandomVariable {
 
+    // Covariance cache keyed on the unordered pair (min id, max id) of
+    // node ids, so (a,b) and (b,a) share one entry and the key holds no
+    // reference.  The table is open addressed: a key may live in either
+    // of two 4-way sets of one cache line each.  It doubles at 3/4 load
+    // while under its memory cap, past the cap a key whose two sets are
+    // full drops the oldest entry of the first one.
+    //
+    // Once set_concurrent(true), lookup() and set() may be called from
+    // several threads: sets are guarded by striped locks and growing
+    // takes the whole table exclusively.
     class _CovarianceMatrix_ : public RCObject {
     public:
 
-		typedef std::pair<RandomVariable,RandomVariable> RowCol;
-		typedef std::map<RowCol,double> Matrix;
+		struct Stats {
+			Stats() : hits(0), misses(0), inserts(0), evictions(0) {}
+			unsigned long hits;
+			unsigned long misses;
+			unsigned long inserts;
+			unsigned long evictions;
+		};
 
-		_CovarianceMatrix_(){}
+		_CovarianceMatrix_();
 		virtual ~_CovarianceMatrix_(){}
 
 		bool lookup( const RandomVariable& a,
 					 const RandomVariable& b, double& cov ) const;
 
 		void set( const RandomVariable& a,
-				  const RandomVariable& b, double cov ){
-			RowCol rowcol(a,b);
-			std::pair<RowCol,double> rowcolv(rowcol,cov);
-			cmat.insert(rowcolv);
+				  const RandomVariable& b, double cov );
+
+		// memory cap in bytes, the table never shrinks below its size
+		void set_max_bytes(size_t max_bytes);
+		size_t max_bytes() const { return max_sets_*sizeof(Set); }
+
+		void set_concurrent(bool is_concurrent) {
+			is_concurrent_ = is_concurrent;
 		}
 
+		size_t size() const { return size_; }
+		size_t bytes() const { return sets_.size()*sizeof(Set); }
+		Stats stats() const;
+		void print_stats(std::ostream& out) const;
+
+		static const size_t default_max_bytes = size_t(1) << 30;
+
+		enum { WAYS = 4 };
+
+		struct Entry {
+			unsigned long long key; // 0 is empty
+			double cov;
+		};
+
     private:
 
-		Matrix cmat;
+		struct alignas(64) Set {
+			Entry way[WAYS];
+		};
+
+		enum { STRIPES = 256 };
+
+		struct alignas(64) Stripe {
+			std::mutex mutex;
+			Stats stats;
+		};
+
+		class Lock;
+
+		static unsigned long long key
+		(
+			const RandomVariable& a,
+			const RandomVariable& b
+			);
+		static unsigned long long hash(unsigned long long key);
+		Stripe& stripe(size_t set) const {
+			return stripes_[set & (STRIPES-1)];
+		}
+		bool is_full() const {
+			return ( max_load*sets_.size()*WAYS < size_ &&
+					 sets_.size() < max_sets_ );
+		}
+		bool insert(unsigned long long key, double cov);
+		void grow();
+
+		static constexpr double max_load = 0.75;
+
+		std::vector<Set> sets_;
+		size_t max_sets_;
+		std::atomic<size_t> size_;
+		std::atomic<unsigned long> grow_evictions_;
+		mutable std::vector<Stripe> stripes_;
+		mutable std::shared_mutex table_mutex_;
+		bool is_concurrent_;
     };
 
     class CovarianceMatrix : public SmartPtr<_CovarianceMatrix_> {
@@ -40,10 +115,19 @@ namespace RandomVariable {
 			( new _CovarianceMatrix_() ) {}
     };
 
-    double covariance(const Normal& a, const Normal& b);
-    double covariance(const RandomVariable& a, const RandomVariable& b);
+    double covariance
+    (
+		Context& context,
+		const Normal& a,
+		const Normal& b
+		);
 
-    CovarianceMatrix& get_covariance_matrix();
+    double covariance
+    (
+		Context& context,
+		const RandomVariable& a,
+		const RandomVariable& b
+		);
 }
 
 #endif // NH_COVARIANCE__H
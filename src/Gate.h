@@ -6,6 +6,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include "SmartPtr.h"
 #include "Statistics.h"
 
@@ -13,19 +14,25 @@ namespace Nh {
 
     typedef ::RandomVariable::Normal Normal;
     typedef ::RandomVariable::RandomVariable RandomVariable;
+    typedef ::RandomVariable::Context Context;
 
-    class _Instance_;
-    typedef SmartPtr<_Instance_> Instance;
-    typedef std::map<std::string,RandomVariable> Signals;
+    typedef std::vector<RandomVariable> Signals; // by Netlist::Node
+
+    // delay of a pin to pin arc as read from .dlib, a fresh Normal of
+    // the analysis is made from it for every instance of the arc
+    struct Delay {
+		Delay() : mean(0.0), variance(0.0) {}
+		Delay(double m, double v) : mean(m), variance(v) {}
+		double mean;
+		double variance;
+    };
 
     /////
 
     class _Gate_ : public RCObject {
     public:
 
-		friend class _Instance_;
-
-		_Gate_() : num_instances_(0) {}
+		_Gate_() {}
 		_Gate_(const std::string type_name) :
 			type_name_(type_name) {
 		}
@@ -40,24 +47,21 @@ namespace Nh {
 		(
 			const std::string& in,
 			const std::string& out,
-			const Normal& delay
+			const Delay& delay
 			);
 
-		const Normal& delay
+		const Delay& delay
 		(
 			const std::string& in,
 			const std::string& out = "y"
 			) const;
 
-		Instance create_instance();
-
 		typedef std::pair<std::string,std::string> IO;
-		typedef std::map<IO,Normal> Delays;
+		typedef std::map<IO,Delay> Delays;
 		const Delays& delays() { return delays_; }
 
     private:
 
-		int num_instances_;
 		std::string type_name_;
 		Delays delays_;
     };
@@ -76,28 +80,6 @@ namespace Nh {
     };
 
 
-    /////
-
-    class _Instance_ : public RCObject {
-    public:
-
-		_Instance_(const Gate& gate) : gate_(gate) {}
-		~_Instance_(){}
-
-		void set_name(const std::string name) { name_ = name; }
-		const std::string& name() const { return name_;	}
-
-		void set_input(const std::string& in_name,
-					   const RandomVariable& signal);
-		RandomVariable output(const std::string& out_name = "y");
-
-    private:
-
-		Gate gate_;
-		std::string name_;
-		Signals inputs_;
-		Signals outputs_;
-    };
 }
 
 #endif // NH_GATE__H
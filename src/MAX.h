@@ -4,6 +4,7 @@
 #ifndef MAX__H
 #define MAX__H
 
+#include <vector>
 #include "RandomVariable.h"
 
 namespace RandomVariable {
@@ -16,8 +17,12 @@ namespace RandomVariable {
 
     public:
 
-		OpMAX( const RandomVariable& left, const RandomVariable& righ );
-		virtual ~OpMAX();
+		OpMAX
+		(
+			Context& context,
+			const RandomVariable& left,
+			const RandomVariable& right
+			);
 
 		const RandomVariable& max0() const { return max0_; }
 
@@ -31,22 +36,63 @@ namespace RandomVariable {
 
     RandomVariable MAX(const RandomVariable& a, const RandomVariable& b);
 
+    // P(a > b) of an evaluated m = MAX(a,b), which may be MAX(b,a) with
+    // structural hashing
+    double tightness(const RandomVariable& m, const RandomVariable& a);
+
+    // a - MAX0(a - b), for required times
+    RandomVariable MIN(const RandomVariable& a, const RandomVariable& b);
+
     //////
 
     class OpMAX0 : public _RandomVariable_ {
     public:
 
-		OpMAX0( const RandomVariable& left );
-		virtual ~OpMAX0();
+		OpMAX0( Context& context, const RandomVariable& left );
 
     private:
 
 		virtual double calc_mean() const ;
 		virtual double calc_variance() const;
-		virtual const RandomVariable& right() const;
     };
 
     RandomVariable MAX0(const RandomVariable& a);
+
+    //////
+
+    // max of n inputs in one node: Clark's pairwise max taken over the
+    // inputs in ascending order of mean, the result kept as a weighted
+    // sum of the inputs.  The weight of an input is the probability it
+    // is the max as the sweep left it, so cov(MAXN, x) is the weighted
+    // sum of cov(input, x).
+    class OpMAXN : public _RandomVariable_ {
+    public:
+
+		OpMAXN
+		(
+			Context& context,
+			const std::vector<RandomVariable>& inputs
+			);
+
+		int size() const { return size_; }
+		const RandomVariable& input(int i) const { return inputs_[i]; }
+
+		// valid once the node is evaluated
+		double weight(int i) const { return weights_[i]; }
+
+    private:
+
+		virtual double calc_mean() const ;
+		virtual double calc_variance() const;
+
+		int size_;
+		RandomVariable* inputs_; // in the arena, as are the weights
+		double* weights_;
+		mutable double variance_max_;
+    };
+
+    // MAX of the inputs as one OpMAXN, or the input itself if only one
+    RandomVariable MAX(const std::vector<RandomVariable>& inputs);
 }
 
 #endif // MAX__H
@@ -0,0 +1,59 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_MODEL__H
+#define NH_MODEL__H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "Netlist.h"
+#include "Corner.h"
+
+namespace Nh {
+
+    // Block timing model of the analysed netlist, --model: its delay
+    // from every primary input to every primary output it reaches, to be
+    // instanced in a parent netlist in place of the block.
+    //
+    // An output o becomes the cell NAME_o of a .dlib with one input pin
+    // per input in its fanin cone, in order of name, so the block is
+    // instanced one output at a time as
+    //   o = NAME_o(i0, i1, ...)
+    // The delay i -> o is the arrival at o with i at 0 and no other
+    // input, propagated as canonical forms through the fanout cone of
+    // i; the inputs are characterised in parallel.  The cells keep no
+    // correlation between their arcs, the file gives it as comments:
+    // the correlation of the outputs with all inputs at 0.  The dffs of
+    // the block launch nothing and their D pins are no outputs, so a
+    // model is of the combinational paths only.
+    class Model {
+    public:
+
+		Model(const Netlist& netlist, Corner& corner);
+
+		void characterize(unsigned int jobs);
+		void write(std::ostream& out, const std::string& name,
+				   unsigned int jobs);
+
+    private:
+
+		Model(const Model&);
+		Model& operator = (const Model&);
+
+		typedef std::vector<Netlist::Node> Nodes;
+
+		struct Arc {
+			Netlist::Node in;
+			Netlist::Node out;
+			Delay delay;
+		};
+		void characterize_input(Netlist::Node in, std::vector<Arc>& arcs) const;
+
+		const Netlist& netlist_;
+		Corner& corner_;
+		std::vector<Arc> arcs_; // by output, then input, in order of name
+    };
+}
+
+#endif // NH_MODEL__H
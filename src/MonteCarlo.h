@@ -0,0 +1,94 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_MONTECARLO__H
+#define NH_MONTECARLO__H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include "Netlist.h"
+#include "Corner.h"
+#include "Writer.h"
+
+namespace Nh {
+
+    // Monte Carlo reference for the analytic arrival times of a corner.
+    // Every random variable of the analysis gets a normal sample: the
+    // arrival of each input and dff and the delay of each fanin edge,
+    // numbered as the sources of the canonical forms.  Samples are taken
+    // in blocks, one array per node, and propagated through the levels
+    // with add and max; the moments and the correlation of the reported
+    // nodes are summed as they stream by.
+    //
+    // The k-th sample of a variable is drawn by a ziggurat from a counter
+    // based hash of (seed, variable, k), so the result does not depend on
+    // the blocking or on the number of threads.
+    class MonteCarlo {
+    public:
+
+		typedef std::vector<Netlist::Node> Nodes;
+
+		MonteCarlo(const Netlist& netlist, const Corner& corner);
+
+		// lat_nodes get their mean and variance, cor_nodes their
+		// correlation matrix
+		void run
+		(
+			unsigned long samples,
+			unsigned long seed,
+			unsigned int jobs,
+			const Nodes& lat_nodes,
+			const Nodes& cor_nodes
+			);
+
+		unsigned long samples() const { return samples_; }
+		double seconds() const { return seconds_; }
+
+		// of lat_nodes[i]
+		double mean(int i) const { return mean_[i]; }
+		double variance(int i) const { return variance_[i]; }
+		// of cor_nodes, n x n
+		const std::vector<double>& correlation() const { return cor_; }
+
+		// beside the analytic values of the corner
+		void report_lat(std::ostream& out, Writer::Format format) const;
+		void report_correlation(std::ostream& out, Writer::Format format) const;
+
+    private:
+
+		MonteCarlo(const MonteCarlo&);
+		MonteCarlo& operator = (const MonteCarlo&);
+
+		// sums of one run of blocks, about the analytic means
+		struct Sums {
+			std::vector<double> lat;	// sum, sum of squares per node
+			std::vector<double> cor;	// sum per node, then upper triangle
+		};
+
+		void run_blocks
+		(
+			unsigned long first,
+			unsigned long last,
+			int block,
+			Sums& sums
+			) const;
+		void sample(uint64_t key, unsigned long first, int n, double* z) const;
+
+		const Netlist& netlist_;
+		const Corner& corner_;
+		unsigned long samples_;
+		unsigned long seed_;
+		double seconds_;
+		Nodes lat_nodes_;
+		Nodes cor_nodes_;
+		std::vector<double> lat_shift_;
+		std::vector<double> cor_shift_;
+		std::vector<double> mean_;
+		std::vector<double> variance_;
+		std::vector<double> cor_;
+    };
+}
+
+#endif // NH_MONTECARLO__H
@@ -0,0 +1,180 @@
+// -*- c++ -*-
+// Authors: IWAI Jiro
+
+#ifndef NH_NETLIST__H
+#define NH_NETLIST__H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+namespace Nh {
+
+    // interned names, id = order of first appearance.  The keys view
+    // the stored names, which a deque never moves.
+    class NameTable {
+    public:
+
+		int intern(std::string_view name);
+		int find(std::string_view name) const;
+		const std::string& name(int id) const { return names_[id]; }
+		int size() const { return names_.size(); }
+
+    private:
+
+		std::unordered_map<std::string_view,int> ids_;
+		std::deque<std::string> names_;
+    };
+
+    // Flat timing graph of a .bench netlist.  A node id is the id of
+    // its signal name, fanin and fanout are CSR arrays and every fanin
+    // edge carries the index of its (gate, pin) arc so that delays are
+    // resolved once per arc rather than once per instance.
+    class Netlist {
+    public:
+
+		class exception {
+		public:
+			exception(const std::string& what): what_(what) {}
+			const std::string& what() { return what_; }
+		private:
+			std::string what_ ;
+		};
+
+		typedef int Node;
+		enum Kind { UNDEFINED = 0, INPUT, DFF, GATE };
+
+		Netlist() : dff_arc_(-1), is_levelized_(false) {}
+
+		// building, false if the node is multiply defined
+		bool add_input(std::string_view name);
+		bool add_dff(std::string_view name, std::string_view in);
+		bool add_gate
+		(
+			std::string_view name,
+			std::string_view type,
+			const std::vector<std::string_view>& ins
+			);
+		bool add_output(std::string_view name);
+
+		void levelize();
+
+		// edits of a levelized netlist: the type of a gate, keeping its
+		// pins, and the driver of one of its pins.  connect() throws if
+		// the edit would close a combinational loop and updates the
+		// levels of the fanout cone of the gate only.
+		void set_type(Node v, std::string_view type);
+		void connect(Node v, int pin, Node u);
+
+		// nodes
+		int num_nodes() const { return names_.size(); }
+		const std::string& name(Node v) const { return names_.name(v); }
+		Node find(std::string_view name) const { return names_.find(name); }
+		Kind kind(Node v) const { return Kind(kind_[v]); }
+		bool is_output(Node v) const { return is_output_[v]; }
+		int level(Node v) const { return level_[v]; }
+
+		// gate type for GATE and DFF nodes
+		const std::string& type(Node v) const {
+			return types_.name(type_[v]);
+		}
+
+		// fanin edges of a gate, in the order its arcs are folded into
+		// the output (pin names compare as strings, "10" < "2").  A dff
+		// has its data input as the only fanin, levelize() does not
+		// follow it and its arc is the ck -> q launch arc.
+		int fanin_begin(Node v) const { return fanin_begin_[v]; }
+		int fanin_end(Node v) const { return fanin_begin_[v+1]; }
+		Node fanin(int e) const { return fanin_[e]; }
+		int num_edges() const { return fanin_.size(); }
+		int pin(int e) const { return pin_[e]; }
+		int arc(int e) const { return arc_[e]; }
+
+		// gate fanouts, dff inputs are not included
+		int fanout_begin(Node v) const { return fanout_begin_[v]; }
+		int fanout_end(Node v) const { return fanout_begin_[v+1]; }
+		Node fanout(int e) const { return fanout_[e]; }
+
+		Node dff_in(Node v) const { return fanin_[fanin_begin_[v]]; }
+		// false if nothing drives the D pin of dff v, which then has no
+		// setup check and launches at the clock edge in every cycle
+		bool is_dff_driven(Node v) const {
+			return kind(dff_in(v)) != UNDEFINED;
+		}
+
+		// arcs
+		int num_arcs() const { return arc_type_.size(); }
+		const std::string& arc_type(int a) const {
+			return types_.name(arc_type_[a]);
+		}
+		const std::string& arc_in(int a) const { return arc_in_[a]; }
+		const std::string& arc_out(int a) const { return arc_out_[a]; }
+		int dff_arc() const { return dff_arc_; } // ck -> q, or -1
+
+		// levels, level 0 holds inputs and dff outputs
+		int num_levels() const { return level_begin_.size()-1; }
+		const std::vector<Node>& order() const { return order_; }
+		int level_begin(int l) const { return level_begin_[l]; }
+		int level_end(int l) const { return level_begin_[l+1]; }
+
+		// marks the roots and every node they depend on, back to the
+		// inputs and dff outputs
+		void fanin_cone(const std::vector<Node>& roots,
+						std::vector<char>& is_cone) const;
+
+		// defined nodes in order of name, for reports
+		const std::vector<Node>& sorted() const { return sorted_; }
+
+		const std::vector<Node>& inputs() const { return inputs_; }
+		const std::vector<Node>& dffs() const { return dffs_; }
+
+    private:
+
+		Node define(std::string_view name, Kind kind);
+		void grow();
+		int intern_arc(int type, int pin);
+		void levelize_error(const std::vector<int>& in_degree) const;
+		void move_fanout(Node v, Node from, Node to);
+		void order_levels();
+
+		NameTable names_;
+		NameTable types_;
+		std::vector<char> kind_;
+		std::vector<int> type_;
+		std::vector<char> is_output_;
+		std::vector<int> level_;
+
+		// gate and dff definitions in file order, CSR built by levelize()
+		std::vector<Node> defs_;
+		std::vector<int> def_begin_;
+		std::vector<Node> def_fanin_;
+
+		std::vector<int> fanin_begin_;
+		std::vector<Node> fanin_;
+		std::vector<int> pin_;
+		std::vector<int> arc_;
+		std::vector<int> fanout_begin_;
+		std::vector<Node> fanout_;
+
+		typedef std::map<std::pair<int,int>,int> ArcIds;
+		ArcIds arc_ids_;
+		std::vector<int> arc_type_;
+		std::vector<std::string> arc_in_;
+		std::vector<std::string> arc_out_;
+		int dff_arc_;
+
+		std::vector<Node> inputs_;
+		std::vector<Node> dffs_;
+		NameTable outputs_;
+
+		std::vector<Node> order_;
+		std::vector<int> level_begin_;
+		std::vector<Node> sorted_;
+		bool is_levelized_;
+    };
+}
+
+#endif // NH_NETLIST__H
@@ -5,18 +5,17 @@
 #define PARSER__H
 
 #include <string>
-#include <fstream>
-#include <boost/tokenizer.hpp>
-#include <boost/lexical_cast.hpp>
-
+#include <string_view>
+#include <charconv>
+#include <type_traits>
+
+// Line oriented tokenizer over a memory mapped file.  Tokens are views
+// into the mapping, so nothing is copied until a caller asks for a
+// std::string.  Drop separators only delimit tokens, keep separators
+// are tokens of one character, and a line whose first token starts
+// with the comment character is skipped.
 class Parser {
 
-private:
-
-    typedef boost::char_separator<char> Separator;
-    typedef boost::tokenizer<Separator> Tokenizer;
-    typedef Tokenizer::iterator Token;
-
 public:
 
     class exception {
@@ -35,48 +34,84 @@ public:
 		const char* drop_separator = " \t"
 		);
 
-    ~Parser() { delete tokenizer_; }
+    // over a copy of text, as one query of --server named name in
+    // the messages
+    Parser
+    (
+		const std::string& name,
+		std::string_view text,
+		const char begin_comment,
+		const char* keep_separator,
+		const char* drop_separator
+		);
+
+    ~Parser();
 
     void checkFile();
 
-    std::istream& getLine();
+    // next line with a token, false at the end of the file
+    bool getLine();
+
+    void getToken( std::string_view& token );
+    void getToken( std::string& token );
+    void getToken( char& c );
 
     template < class U >
     void getToken( U& u )
 		{
+			static_assert( std::is_arithmetic<U>::value,
+						   "Parser::getToken: unsupported type" );
 			checkTermination();
-			try {
-				u = boost::lexical_cast<U>(*token_);
-			} catch ( boost::bad_lexical_cast& e ){
-				unexpectedToken_(*token_);
-			}
-			pre_ = *token_;
-			token_++;
+			const char* first = token_.data();
+			const char* last = first + token_.size();
+			if( first != last && *first == '+' ) first++;
+			std::from_chars_result r = std::from_chars(first, last, u);
+			if( r.ec != std::errc() || r.ptr != last || first == last )
+				unexpectedToken_(token_);
+			next();
 		}
 
     void checkSepalator( char sepalator );
     void checkEnd();
+    bool isEnd() const { return token_.empty(); } // of the current line
     void unexpectedToken();
     const std::string& getFileName() const { return file_; }
     int getNumLine() const { return line_number_; }
+    int getNumColumn() const { return column(pre_); } // of the last token
 
 private:
 
-    void unexpectedToken_(const std::string& token);
-    bool fail() const { return infile_.fail(); }
+    Parser(const Parser&);
+    Parser& operator = (const Parser&);
+
+    enum { TEXT = 0, DROP, KEEP };
+
+    void set_classes(const char* keep_separator, const char* drop_separator);
+    void open();
+    void next();
+    void skipLine();
     void checkTermination();
-    Token& begin() { token_ = tokenizer_->begin(); return token_; }
-    Token end() { return tokenizer_->end(); }
+    void unexpectedToken_(std::string_view token);
+    int column(std::string_view token) const {
+		return token.data() - line_ + 1;
+    }
+    std::string where(std::string_view token) const;
 
-    int line_number_;
     std::string file_;
-    std::string line_;
-    std::ifstream infile_;
-    Separator sepalator_;
+    unsigned char class_[256];
     const char begin_comment_;
-    Tokenizer* tokenizer_;
-    std::string pre_;
-    Token token_;
+
+    bool is_open_;
+    void* map_;
+    size_t map_size_;
+    std::string buffer_; // when the file can not be mapped
+    const char* cursor_;
+    const char* end_;
+
+    int line_number_;
+    const char* line_; // first character of the current line
+    std::string_view token_; // empty at the end of the line
+    std::string_view pre_;
 };
 
 #endif	// PARSER__H
@@ -4,9 +4,9 @@
 #ifndef RANDOM_VARIABLE__H
 #define RANDOM_VARIABLE__H
 
+#include <atomic>
 #include <string>
 
-#include "SmartPtr.h"
 
 namespace RandomVariable {
 
@@ -20,17 +20,52 @@ namespace RandomVariable {
 		std::string what_ ;
 	};
 
+	class Context;
 	class _RandomVariable_;
-	typedef SmartPtr<_RandomVariable_> RandomVariable;
 
-	class _RandomVariable_ : public RCObject {
+	// Non-owning handle to a node.  Nodes live in the arena of their
+	// context and go away with it, so handles are plain pointers that
+	// convert from derived to base node types only.
+	template < class T >
+	class NodePtr {
 	public:
 
-		_RandomVariable_();
-		virtual ~_RandomVariable_();
+		NodePtr( T* pointee = 0 ) : pointee_(pointee) {}
 
-		const std::string& name() const;
-		void set_name(const std::string& name);
+		template < class U >
+		NodePtr( const NodePtr<U>& org ) : pointee_(org.get()) {}
+
+		bool operator == ( const NodePtr& rhs ) const {
+			return ( pointee_ == rhs.pointee_ );
+		}
+
+		bool operator != ( const NodePtr& rhs ) const {
+			return ( pointee_ != rhs.pointee_ );
+		}
+
+		bool operator < ( const NodePtr& rhs ) const {
+			return ( pointee_ < rhs.pointee_ );
+		}
+
+		T* operator -> () const { return (pointee_); }
+		T& operator * () const { return (*pointee_); }
+		T* get() const { return (pointee_); }
+
+	private:
+
+		T* pointee_;
+	};
+
+	typedef NodePtr<_RandomVariable_> RandomVariable;
+
+	// operation of a node, covariance() dispatches on the pair
+	enum Kind { OP_NORMAL = 0, OP_ADD, OP_SUB, OP_MAX, OP_MAX0, OP_MAXN,
+				 NUM_KINDS };
+
+	// A node of the expression DAG, created in the arena of its context
+	// by Context::create() and never destroyed on its own.
+	class _RandomVariable_ {
+	public:
 
 		const RandomVariable& left() const;
 		const RandomVariable& right() const;
@@ -39,23 +74,38 @@ namespace RandomVariable {
 		double variance();
 
 		int level() const { return level_; }
+		Kind kind() const { return Kind(kind_); }
+
+		// A Normal of at most minimum_variance, a constant delay or the
+		// arrival of an input, or an operation on deterministic nodes
+		// only.  It is a plain scalar of the least variance, whose
+		// covariance with every other node is 0.
+		bool is_deterministic() const { return is_deterministic_; }
+
+		// unique within the context and never reused, keys the
+		// covariance cache
+		unsigned int id() const { return id_; }
+		Context* context() const { return context_; }
 
 	protected:
 
 		_RandomVariable_
 		(
+			Context& context,
 			double mean,
-			double variance,
-			const std::string& name = ""
+			double variance
 			);
 
 		_RandomVariable_
 		(
+			Context& context,
+			Kind kind,
 			const RandomVariable& left,
-			const RandomVariable& right,
-			const std::string& name = ""
+			const RandomVariable& right
 			);
 
+		~_RandomVariable_() {}
+
 	protected:
 
 		virtual double calc_mean() const;
@@ -63,15 +113,27 @@ namespace RandomVariable {
 
 		void check_variance(double& v) const;
 
-		std::string name_;
 		RandomVariable left_;
 		RandomVariable right_;
 		double mean_;
 		double variance_;
 
-		bool is_set_mean_;
-		bool is_set_variance_;
+		// UNEVALUATED, then EVALUATING by the one thread that claims
+		// the node, then EVALUATED with mean_ and variance_ published
+		enum State { UNEVALUATED = 0, EVALUATING, EVALUATED };
+		std::atomic<unsigned char> state_;
+		bool is_evaluated() const {
+			return state_.load(std::memory_order_acquire) == EVALUATED;
+		}
+		bool is_deterministic_;
+		unsigned char kind_;
 		int level_;
+		Context* context_;
+		unsigned int id_;
+
+	private:
+
+		void evaluate();
 	};
 
 }
@@ -11,8 +11,12 @@ namespace RandomVariable {
     class OpSUB : public _RandomVariable_ {
     public:
 
-		OpSUB( const RandomVariable& left, const RandomVariable& righ );
-		virtual ~OpSUB();
+		OpSUB
+		(
+			Context& context,
+			const RandomVariable& left,
+			const RandomVariable& right
+			);
 
     private:
 
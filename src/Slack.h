@@ -0,0 +1,92 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_SLACK__H
+#define NH_SLACK__H
+
+#include <vector>
+#include <ostream>
+#include "Netlist.h"
+#include "Corner.h"
+#include "Writer.h"
+
+namespace Nh {
+
+    // Required times, slacks and criticalities of a propagated corner,
+    // by a backward pass over its levels.
+    //
+    // Every endpoint, a primary output or the D pin of a dff, is
+    // required at one time.  The required time of a node is the min over
+    // its fanout edges of the required time of the gate less the delay
+    // of the edge, as the arrival is the max over the fanin edges, and
+    // its slack is required - arrival.  The expression DAG gets the
+    // required times as nodes of its own context, min(a,b) = a - max0(a
+    // - b), so the slack takes the covariance with the arrival from the
+    // cache of the forward pass; --canonical takes it from the
+    // coefficients, the residual of the min at node v being source
+    // Corner::num_sources() + v.  A level depends on the levels above it
+    // only and is evaluated in parallel.
+    //
+    // The criticality of an edge is the probability that it is on the
+    // critical path: the criticality of its gate times the probability
+    // that the edge is the max there, Corner::fanin_weights().  A node
+    // adds up its fanout edges, an endpoint starts from the probability
+    // that it is the latest one.  Paths are ranked by the product of the
+    // weights along them, which is found best first from the endpoints.
+    class Slack {
+    public:
+
+		Slack(const Netlist& netlist, const Corner& corner);
+
+		// required at the endpoints, or at the latest mean arrival of
+		// them if not positive
+		void run(double required, unsigned int jobs);
+		double required() const { return required_; }
+
+		// of the nodes with an endpoint in the fanout cone
+		bool has_required(Netlist::Node v) const { return has_required_[v]; }
+		double mean(Netlist::Node v) const { return slack_mean_[v]; }
+		double variance(Netlist::Node v) const { return slack_variance_[v]; }
+		double criticality(Netlist::Node v) const { return criticality_[v]; }
+
+		// the node table, and the k most critical paths
+		void report_slack(std::ostream& out, Writer::Format format) const;
+		void report_paths(std::ostream& out, int k, Writer::Format format) const;
+
+    private:
+
+		Slack(const Slack&);
+		Slack& operator = (const Slack&);
+
+		typedef std::vector<Netlist::Node> Nodes;
+
+		void find_endpoints();
+		void run_canonical(unsigned int jobs);
+		void run_dag(unsigned int jobs);
+		void run_criticality(unsigned int jobs);
+		bool is_first_fanout(Netlist::Node u, int f) const;
+
+		// source ... endpoint
+		struct Path {
+			double criticality;
+			Nodes nodes;
+		};
+		void critical_paths(int k, std::vector<Path>& paths) const;
+
+		const Netlist& netlist_;
+		const Corner& corner_;
+		double required_;
+		Nodes endpoints_; // in order of name
+		std::vector<char> is_endpoint_;
+		std::vector<char> has_required_;
+		std::vector<double> required_mean_;
+		std::vector<double> required_variance_;
+		std::vector<double> slack_mean_;
+		std::vector<double> slack_variance_;
+		std::vector<double> weights_; // by fanin edge
+		std::vector<double> latest_; // P(the latest endpoint), by node
+		std::vector<double> criticality_;
+    };
+}
+
+#endif // NH_SLACK__H
@@ -22,7 +22,7 @@ public:
     SmartPtr( const SmartPtr& org )
 		: pointee_(org.pointee_){ refer(); }
 
-    virtual ~SmartPtr(){ release(); }
+    ~SmartPtr(){ release(); }
 
     SmartPtr& operator = ( const SmartPtr& rhs ){
 		if( pointee_ == rhs.pointee_ )
@@ -41,11 +41,11 @@ public:
 		return ( pointee_ != rhs.pointee_ );
     }
 
-    virtual bool operator < ( const SmartPtr& rhs ) const {
+    bool operator < ( const SmartPtr& rhs ) const {
 		return ( pointee_ < rhs.pointee_ );
     }
 
-    virtual bool operator > ( const SmartPtr& rhs ) const {
+    bool operator > ( const SmartPtr& rhs ) const {
 		return ( pointee_ > rhs.pointee_ );
     }
 
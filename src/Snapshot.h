@@ -0,0 +1,142 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_SNAPSHOT__H
+#define NH_SNAPSHOT__H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "Netlist.h"
+#include "Corner.h"
+
+namespace Nh {
+
+    // Binary image of an analysed netlist: the node table, the levels,
+    // and for every corner the mean and variance of each node with the
+    // canonical forms (--canonical) or the correlation matrix of the
+    // nodes reported by -c.  All records are fixed size and 8 byte
+    // aligned, so a loaded snapshot is the mapped file itself and reads
+    // nothing until it is queried.  The byte order is the host's.
+    class Snapshot {
+    public:
+
+		class exception {
+		public:
+			exception(const std::string& what): what_(what) {}
+			const std::string& what() { return what_; }
+		private:
+			std::string what_ ;
+		};
+
+		typedef Netlist::Node Node;
+		typedef std::vector<Node> Nodes;
+
+		static void save
+		(
+			const std::string& file,
+			const Netlist& netlist,
+			const std::vector<const Corner*>& corners
+			);
+
+		// maps file read only
+		explicit Snapshot(const std::string& file);
+		~Snapshot();
+
+		const std::string& file() const { return file_; }
+		size_t bytes() const { return bytes_; }
+
+		// nodes
+		int num_nodes() const { return header_->num_nodes; }
+		std::string_view name(Node v) const;
+		// -1 if there is no such node
+		Node find(std::string_view name) const;
+		Netlist::Kind kind(Node v) const { return Netlist::Kind(nodes_[v].kind); }
+		bool is_output(Node v) const { return nodes_[v].is_output; }
+		int level(Node v) const { return nodes_[v].level; }
+		int num_levels() const { return header_->num_levels; }
+		// defined nodes in order of name, as Netlist::sorted()
+		Nodes sorted() const;
+
+		// corners
+		int num_corners() const { return header_->num_corners; }
+		std::string_view dlib(int c) const;
+		bool is_canonical() const { return header_->is_canonical; }
+		double mean(int c, Node v) const;
+		double variance(int c, Node v) const;
+
+		// n x n correlation of the nodes, throws unless the snapshot
+		// holds canonical forms or every node was reported by -c
+		void correlation_matrix
+		(
+			int c,
+			const Nodes& nodes,
+			std::vector<double>& cor
+			) const;
+
+    private:
+
+		Snapshot(const Snapshot&);
+		Snapshot& operator = (const Snapshot&);
+
+		struct Header {
+			char magic[8];
+			uint64_t bytes;
+			uint32_t byte_order;
+			uint32_t version;
+			uint32_t num_nodes;
+			uint32_t num_levels;
+			uint32_t num_corners;
+			uint32_t is_canonical;
+			uint64_t names;		// char[]
+			uint64_t nodes;		// NodeRecord[num_nodes]
+			uint64_t sorted;	// int32_t[num_sorted]
+			uint64_t num_sorted;
+			uint64_t corners;	// CornerRecord[num_corners]
+		};
+
+		struct NodeRecord {
+			uint64_t name;
+			uint32_t name_size;
+			int32_t level;
+			uint8_t kind;
+			uint8_t is_output;
+			uint8_t pad[6];
+		};
+
+		struct CornerRecord {
+			uint64_t dlib;		// char[dlib_size]
+			uint64_t dlib_size;
+			uint64_t mean;		// double[num_nodes]
+			uint64_t variance;	// double[num_nodes]
+			uint64_t term_begin;	// uint64_t[num_nodes+1], --canonical
+			uint64_t terms;		// TermRecord[]
+			uint64_t cor_nodes;	// int32_t[num_cor]
+			uint64_t num_cor;
+			uint64_t cor;		// double[num_cor*num_cor]
+		};
+
+		struct TermRecord {
+			int32_t source;
+			int32_t pad;
+			double coef;
+		};
+
+		class Image;
+
+		template<class T> const T* at(uint64_t offset) const {
+			return reinterpret_cast<const T*>(data_ + offset);
+		}
+		const CornerRecord& corner(int c) const;
+		double covariance(const CornerRecord& r, Node u, Node v) const;
+
+		std::string file_;
+		const char* data_;
+		size_t bytes_;
+		const Header* header_;
+		const NodeRecord* nodes_;
+    };
+}
+
+#endif // NH_SNAPSHOT__H
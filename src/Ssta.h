@@ -4,17 +4,21 @@
 #ifndef NH_SSTA__H
 #define NH_SSTA__H
 
-#include <set>
-#include <map>
-#include <list>
+#include <memory>
 #include <vector>
 #include <string>
-#include "SmartPtr.h"
-#include "Gate.h"
+#include <string_view>
+#include <iostream>
+#include "Corner.h"
+#include "Netlist.h"
 #include "Parser.h"
+#include "Writer.h"
+#include "Timer.h"
 
 namespace Nh {
 
+    class Snapshot;
+
     class Ssta {
     public:
 
@@ -26,6 +30,8 @@ namespace Nh {
 			std::string what_ ;
 		};
 
+		typedef std::vector<Netlist::Node> Nodes;
+
 		Ssta();
 		~Ssta();
 		void check();
@@ -35,77 +41,185 @@ namespace Nh {
 
     private:
 
-		typedef std::vector<std::string> Ins;
-
-		class NetLineBody : public RCObject {
-		public:
-			NetLineBody(){}
-			~NetLineBody(){}
-
-			void set_out(const std::string& out) { out_ = out; }
-			const std::string& out() const { return out_; }
-
-			void set_gate(const std::string& gate) { gate_ = gate; }
-			const std::string& gate() const { return gate_; }
-
-			const Ins& ins() const{ return ins_; }
-			Ins& ins() { return ins_; }
-
-		private:
-			std::string out_;
-			std::string gate_;
-			Ins ins_;
-		};
-
-		class NetLine : public SmartPtr<NetLineBody> {
-		public:
-			NetLine() : SmartPtr<NetLineBody>( new NetLineBody() ) {}
-		};
-
-		void read_dlib_line(Parser& parser);
 		void read_bench_input(Parser& parser);
 		void read_bench_output(Parser& parser);
-		void read_bench_net(Parser& parser,const std::string& out_signal_name);
-		void set_dff_out(const std::string& out_signal_name);
-		void connect_instances();
-		bool is_line_ready(const NetLine& line) const;
-		void set_instance_input(const Instance& inst, const Ins& ins);
-		void check_signal(const std::string& signal_name) const;
+		void read_bench_net(Parser& parser, std::string_view out_signal_name);
 
 		void node_error
 		(
 			const std::string& head,
-			const std::string& signal_name
+			std::string_view signal_name
+			) const;
+
+		void read_eco();
+		void read_eco_set_delay(Parser& parser, Nodes& dirty);
+		void read_eco_set_gate(Parser& parser, Nodes& dirty);
+		void read_eco_connect(Parser& parser, Nodes& dirty);
+		void read_eco_report(Parser& parser, Nodes& dirty, std::ostream& out);
+		void read_eco_nodes(Parser& parser, Nodes& nodes) const;
+		Netlist::Node eco_node(Parser& parser) const;
+		void update(Nodes& dirty);
+
+		// --server
+		enum Reply { CONTINUE, QUIT, SHUTDOWN };
+		void serve();
+		void serve_socket();
+		Reply serve_connection(int fd);
+		Reply query(const std::string& line, std::ostream& out);
+		void answer_json(std::ostream& out, bool is_lat, const Nodes& nodes);
+
+		void report_corner
+		(
+			std::ostream& out,
+			Corner& corner,
+			const Nodes& lat_nodes,
+			const Nodes& nodes,
+			unsigned int jobs
+			);
+		void print_corner
+		(
+			std::ostream& out,
+			std::string_view dlib,
+			int num_corners
 			) const;
+		std::ostream& out() const { return ( output_ ? *output_ : std::cout ); }
+		void correlation_nodes(Nodes& nodes) const;
+		void read_nodes(const std::string& file, Nodes& nodes) const;
 
-		void report_lat() const;
-		void report_correlation() const;
-		void print_line() const;
+		void save() const;
+		void write_model();
+		void report_snapshot() const;
+		// --stats and --stats-json, of the corners or of the snapshot
+		void report_stats(const Snapshot* snapshot) const;
 
 		////
 
-		typedef std::map<std::string,Gate> Gates;
-		typedef std::list<NetLine> Net;
-		typedef std::set<std::string> Pins;
+		typedef std::unique_ptr<Corner> CornerPtr;
 
-		std::string dlib_;
+		std::vector<std::string> dlibs_;
 		std::string bench_;
 		bool is_lat_;
 		bool is_correlation_;
-		Gates gates_;
-		Signals signals_;
-		Net net_;
-		Pins inputs_;
-		Pins outputs_;
+		double cor_threshold_; // of the sparse -c, 0 for the matrix
+		unsigned int cor_top_; // by node, 0 for all
+		bool is_stats_;
+		std::string stats_json_;
+		unsigned int jobs_;
+		bool is_outputs_;
+		std::string nodes_;
+		std::string eco_;
+		bool is_server_;
+		std::string socket_; // of --server, std::cin if empty
+		Nodes dirty_; // edits of --server not yet reported
+		std::string save_;
+		std::string model_;
+		std::string load_;
+		Writer::Format format_;
+		std::string output_file_;
+		std::unique_ptr<std::ostream> output_; // -o, or std::cout
+		double clock_period_; // 0 for none
+		unsigned int cycles_;
+		bool is_slack_;
+		unsigned int paths_; // 0 for none
+		unsigned long monte_carlo_; // samples, 0 for none
+		unsigned long seed_;
+		Timer timer_; // since the start
+		double dlib_seconds_;
+		double bench_seconds_;
+		std::string endpoints_;
+		Nodes endpoints_nodes_;
+		std::vector<char> is_endpoint_cone_;
+		Corner::Options options_;
+		Netlist netlist_;
+		std::vector<CornerPtr> corners_; // by -d, in order
+		std::vector<std::string_view> ins_; // views into the .bench
 
     public:
 
 		void set_lat() { is_lat_ = true; }
 		void set_correlation() { is_correlation_ = true; }
-
-		void set_dlib(std::string dlib) { dlib_ = dlib; }
+		// -c as the entries of at least the threshold, or the top of
+		// them by node, see Corner::select_correlation()
+		void set_cor_threshold(double threshold) { cor_threshold_ = threshold; }
+		void set_cor_top(unsigned int top) { cor_top_ = top; }
+		bool is_sparse() const { return cor_threshold_ != 0.0 || cor_top_; }
+		// phase times, counts and memory of the run to std::cerr, or as
+		// JSON to a file
+		void set_stats() { is_stats_ = true; options_.is_counting = true; }
+		void set_stats_json(std::string file) {
+			stats_json_ = file;
+			options_.is_counting = true;
+		}
+		void set_cache_size(unsigned int mbytes);
+		void set_jobs(unsigned int jobs) { jobs_ = ( jobs ? jobs : 1 ); }
+		void set_nary_max() { options_.is_nary_max = true; }
+		// shares the nodes of equal operations on equal operands, the
+		// constant delays and the arrival of inputs and dffs
+		void set_strash() { options_.is_strash = true; }
+
+		// arrival times in canonical form instead of the expression DAG
+		void set_canonical() { options_.is_canonical = true; }
+		// drops canonical coefficients below threshold of the variance
+		void set_prune(double threshold) { options_.prune = threshold; }
+		// canonical forms of float scalars, half the bytes a term, for
+		// quick sweeps; double, the default, is for sign-off
+		void set_precision(bool is_float) {
+			options_.is_float = is_float;
+			if( is_float ) options_.is_canonical = true;
+		}
+
+		// correlation matrix of the primary outputs or of listed nodes
+		void set_outputs() { is_outputs_ = true; }
+		void set_nodes(std::string nodes) { nodes_ = nodes; }
+
+		// builds, evaluates and reports the fanin cones of the nodes
+		// listed in the file only
+		void set_endpoints(std::string endpoints) { endpoints_ = endpoints; }
+
+		// edits and reports after the analysis, see read_eco()
+		void set_eco(std::string eco) { eco_ = eco; }
+
+		// keeps the analysed design and answers queries, see serve()
+		void set_server() { is_server_ = true; }
+		void set_socket(std::string socket) {
+			is_server_ = true;
+			socket_ = socket;
+		}
+
+		// writes the block model of the analysed netlist to a .dlib,
+		// see Model
+		void set_model(std::string model) { model_ = model; }
+
+		// writes the analysed netlist to a snapshot, which --load
+		// reports from instead of reading -d and -b
+		void set_save(std::string save) { save_ = save; }
+		void set_load(std::string load) { load_ = load; }
+
+		// setup at the dff data pins against the clock period, after
+		// the given number of cycles, see Corner::next_cycle()
+		void set_clock_period(double period) { clock_period_ = period; }
+		void set_cycles(unsigned int cycles) { cycles_ = cycles; }
+
+		// required times, slacks and criticalities of the nodes, and the
+		// most critical paths, see Slack
+		void set_slack() { is_slack_ = true; }
+		void set_paths(unsigned int k) { paths_ = k; }
+
+		// a Monte Carlo run beside the analytic -l and -c reports
+		void set_monte_carlo(unsigned long samples) { monte_carlo_ = samples; }
+		void set_seed(unsigned long seed) { seed_ = seed; }
+
+		// report format and file, std::cout by default
+		void set_format(Writer::Format format) { format_ = format; }
+		void set_output(std::string output) { output_file_ = output; }
+
+		// every -d adds a corner, all of them are analysed on the one
+		// netlist and reported in order
+		void set_dlib(std::string dlib) { dlibs_.push_back(dlib); }
 		void set_bench(std::string bench) { bench_ = bench; }
 
+		const Netlist& netlist() const { return netlist_; }
+
     };
 }
 
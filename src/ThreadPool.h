@@ -0,0 +1,62 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_THREAD_POOL__H
+#define NH_THREAD_POOL__H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+namespace Nh {
+
+    // Fixed set of workers for data parallel loops.  The calling thread
+    // takes part in every loop, so ThreadPool(1) starts no thread.
+    class ThreadPool {
+    public:
+
+		explicit ThreadPool(int num_threads);
+		~ThreadPool();
+
+		int size() const { return workers_.size()+1; }
+
+		// f(i) for 0 <= i < n, in chunks of grain indices taken in
+		// order; returns when all are done and rethrows the first
+		// exception thrown by f
+		void parallel_for
+		(
+			int n,
+			const std::function<void(int)>& f,
+			int grain = 1
+			);
+
+    private:
+
+		ThreadPool(const ThreadPool&);
+		ThreadPool& operator = (const ThreadPool&);
+
+		void work();
+		void run();
+
+		std::vector<std::thread> workers_;
+		std::mutex mutex_;
+		std::condition_variable start_;
+		std::condition_variable done_;
+		unsigned long generation_;
+		int active_;
+		bool is_stopping_;
+
+		// current loop
+		const std::function<void(int)>* f_;
+		int n_;
+		int grain_;
+		std::atomic<int> next_;
+		std::exception_ptr error_;
+    };
+}
+
+#endif // NH_THREAD_POOL__H
@@ -0,0 +1,48 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_TIMER__H
+#define NH_TIMER__H
+
+#include <chrono>
+
+namespace Nh {
+
+    // wall clock time since construction or restart(), for --stats
+    class Timer {
+    public:
+
+		Timer() : start_(Clock::now()) {}
+
+		void restart() { start_ = Clock::now(); }
+
+		double seconds() const {
+			return std::chrono::duration<double>(Clock::now() - start_).count();
+		}
+
+    private:
+
+		typedef std::chrono::steady_clock Clock;
+
+		Clock::time_point start_;
+    };
+
+    // adds the wall clock time of a scope to seconds as it is left,
+    // also by an exception
+    class ScopedTimer {
+    public:
+
+		explicit ScopedTimer(double& seconds) : seconds_(seconds) {}
+		~ScopedTimer() { seconds_ += timer_.seconds(); }
+
+    private:
+
+		ScopedTimer(const ScopedTimer&);
+		ScopedTimer& operator = (const ScopedTimer&);
+
+		double& seconds_;
+		Timer timer_;
+    };
+}
+
+#endif // NH_TIMER__H
@@ -4,14 +4,14 @@
 #ifndef NH_UTIL__H
 #define NH_UTIL__H
 
-#include <string>
-
 namespace RandomVariable {
 
     double MeanMax(double mu);
     double MeanMax2(double mu);
     double MeanPhiMax(double mu);
 
+    // standard normal distribution Phi(a) and density phi(a)
+    void NormalDistribution(double a, double& Phi, double& phi);
 
 }
 
@@ -0,0 +1,67 @@
+// -*- c++ -*-
+// Author: IWAI Jiro
+
+#ifndef NH_WRITER__H
+#define NH_WRITER__H
+
+#include <string>
+#include <ostream>
+
+namespace Nh {
+
+    // Buffered output for large reports: cells are converted with
+    // std::to_chars into a local buffer that goes to the stream in large
+    // blocks instead of one format object and flush per cell.
+    class Writer {
+    public:
+
+		// of the -l and -c reports: aligned text, CSV, or packed
+		// binary records (see Corner::print_lat())
+		enum Format { TEXT, CSV, BINARY };
+
+		explicit Writer(std::ostream& out, size_t capacity = 1 << 16);
+		~Writer() { flush(); }
+
+		Writer& put(char c) {
+			buffer_ += c;
+			if( capacity_ <= buffer_.size() ) flush();
+			return *this;
+		}
+
+		Writer& operator << (const std::string& s);
+
+		// s padded with blanks to width on the right
+		Writer& left(const std::string& s, int width);
+
+		// x with precision digits after the point, right aligned in
+		// width; or in the shortest form that reads back as x
+		Writer& fixed(double x, int precision, int width = 0);
+		Writer& shortest(double x);
+
+		// bytes as they are, for BINARY
+		Writer& write(const void* p, size_t n);
+		template<class T> Writer& write(const T& x) {
+			return write(&x, sizeof(x));
+		}
+
+		void flush();
+
+		// the stream of -o FILE, compressed on the fly if FILE ends in
+		// ".gz"; 0 if it can not be opened or nhssta is built without
+		// zlib (has_gzip())
+		static std::ostream* open(const std::string& file);
+		static bool has_gzip();
+		static bool is_gzip(const std::string& file);
+
+    private:
+
+		Writer(const Writer&);
+		Writer& operator = (const Writer&);
+
+		std::ostream& out_;
+		size_t capacity_;
+		std::string buffer_;
+    };
+}
+
+#endif // NH_WRITER__H